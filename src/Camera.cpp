@@ -1,27 +1,78 @@
 #include "Camera.hpp"
 
-Camera::Camera(glm::vec3 position, glm::vec3 up, float yaw, float pitch) : Front(glm::vec3(0.0f, 0.0f, -1.0f)), MovementSpeed(SPEED), MouseSensitivity(SENSITIVITY), Zoom(ZOOM)
+Camera::Camera(glm::vec3 position, glm::vec3 up, float yaw, float pitch) : Front(glm::vec3(0.0f, 0.0f, -1.0f)), MovementSpeed(SPEED), MouseSensitivity(SENSITIVITY), Zoom(ZOOM), AspectRatio(ASPECT), NearPlane(ZNEAR), FarPlane(ZFAR)
 {
 	Position = position;
 	WorldUp = up;
 	Yaw = yaw;
 	Pitch = pitch;
 	updateCameraVectors();
+	updateView();
+	updateProjection();
+	updateViewProjection();
 }
 // Constructor with scalar values
-Camera::Camera(float posX, float posY, float posZ, float upX, float upY, float upZ, float yaw, float pitch) : Front(glm::vec3(0.0f, 0.0f, -1.0f)), MovementSpeed(SPEED), MouseSensitivity(SENSITIVITY), Zoom(ZOOM)
+Camera::Camera(float posX, float posY, float posZ, float upX, float upY, float upZ, float yaw, float pitch) : Front(glm::vec3(0.0f, 0.0f, -1.0f)), MovementSpeed(SPEED), MouseSensitivity(SENSITIVITY), Zoom(ZOOM), AspectRatio(ASPECT), NearPlane(ZNEAR), FarPlane(ZFAR)
 {
 	Position = glm::vec3(posX, posY, posZ);
 	WorldUp = glm::vec3(upX, upY, upZ);
 	Yaw = yaw;
 	Pitch = pitch;
 	updateCameraVectors();
+	updateView();
+	updateProjection();
+	updateViewProjection();
 }
 
 // Returns the view matrix calculated using Euler Angles and the LookAt Matrix
-glm::mat4 Camera::GetViewMatrix()
+const glm::mat4& Camera::GetViewMatrix()
 {
-	return glm::lookAt(Position, Position + Front, Up);
+	if (isViewDirty())
+		updateView();
+	return view;
+}
+
+// Returns the camera-to-world matrix
+const glm::mat4& Camera::GetInverseViewMatrix()
+{
+	if (isViewDirty())
+		updateView();
+	return inverseView;
+}
+
+// Returns the perspective projection matrix built from Zoom, AspectRatio, NearPlane and FarPlane
+const glm::mat4& Camera::GetProjectionMatrix()
+{
+	if (isProjectionDirty())
+		updateProjection();
+	return projection;
+}
+
+// Returns the clip-to-view matrix
+const glm::mat4& Camera::GetInverseProjectionMatrix()
+{
+	if (isProjectionDirty())
+		updateProjection();
+	return inverseProjection;
+}
+
+// Returns projection * view
+const glm::mat4& Camera::GetViewProjectionMatrix()
+{
+	if (isViewDirty())
+		updateView();
+	if (isProjectionDirty())
+		updateProjection();
+	if (viewProjectionDirty)
+		updateViewProjection();
+	return viewProjection;
+}
+
+// Returns the clip-to-world matrix
+const glm::mat4& Camera::GetInverseViewProjectionMatrix()
+{
+	GetViewProjectionMatrix();
+	return inverseViewProjection;
 }
 
 // Processes input received from any keyboard-like input system. Accepts input parameter in the form of camera defined ENUM (to abstract it from windowing systems)
@@ -74,13 +125,95 @@ void Camera::ProcessMouseScroll(float yoffset)
 // Calculates the front vector from the Camera's (updated) Euler Angles
 void Camera::updateCameraVectors()
 {
-	// Calculate the new Front vector
-	glm::vec3 front;
-	front.x = cos(glm::radians(Yaw)) * cos(glm::radians(Pitch));
-	front.y = sin(glm::radians(Pitch));
-	front.z = sin(glm::radians(Yaw)) * cos(glm::radians(Pitch));
-	Front = glm::normalize(front);
+	float yaw = glm::radians(Yaw);
+	float pitch = glm::radians(Pitch);
+	float cosPitch = cos(pitch);
+	// The new Front vector is already unit length, so it needs no normalization
+	Front = glm::vec3(cos(yaw) * cosPitch, sin(pitch), sin(yaw) * cosPitch);
 	// Also re-calculate the Right and Up vector
 	Right = glm::normalize(glm::cross(Front, WorldUp));  // Normalize the vectors, because their length gets closer to 0 the more you look up or down which results in slower movement.
-	Up = glm::normalize(glm::cross(Right, Front));
+	Up = glm::cross(Right, Front);  // Right and Front are orthonormal, so Up is unit length as well
+}
+
+// Builds the view matrix and its inverse. Equivalent to glm::lookAt(Position, Position + Front, Up)
+void Camera::updateView()
+{
+	// Re-derive an orthonormal basis the way lookAt does, so Front and Up may also be written directly
+	glm::vec3 f = glm::normalize(Front);
+	glm::vec3 s = glm::normalize(glm::cross(f, Up));
+	glm::vec3 u = glm::cross(s, f);
+
+	view = glm::mat4(1.0f);
+	view[0][0] = s.x;
+	view[1][0] = s.y;
+	view[2][0] = s.z;
+	view[0][1] = u.x;
+	view[1][1] = u.y;
+	view[2][1] = u.z;
+	view[0][2] = -f.x;
+	view[1][2] = -f.y;
+	view[2][2] = -f.z;
+	view[3][0] = -glm::dot(s, Position);
+	view[3][1] = -glm::dot(u, Position);
+	view[3][2] = glm::dot(f, Position);
+
+	// The rotation part is orthonormal, so the inverse is its transpose followed by the translation back to Position
+	inverseView[0] = glm::vec4(s, 0.0f);
+	inverseView[1] = glm::vec4(u, 0.0f);
+	inverseView[2] = glm::vec4(-f, 0.0f);
+	inverseView[3] = glm::vec4(Position, 1.0f);
+
+	viewPosition = Position;
+	viewFront = Front;
+	viewUp = Up;
+	viewProjectionDirty = true;
+}
+
+// Builds the projection matrix and its inverse. Equivalent to glm::perspective(glm::radians(Zoom), AspectRatio, NearPlane, FarPlane)
+// for a valid frustum; a near plane at or behind the eye or a far plane in front of the near plane is clamped, so the inverse stays finite
+void Camera::updateProjection()
+{
+	float zNear = glm::max(NearPlane, MIN_ZNEAR);
+	float zFar = glm::max(FarPlane, zNear + MIN_ZNEAR);
+	float tanHalfFovy = tan(glm::radians(Zoom) * 0.5f);
+	float depth = zFar - zNear;
+	float nearFar = 2.0f * zFar * zNear;
+
+	projection = glm::mat4(0.0f);
+	projection[0][0] = 1.0f / (AspectRatio * tanHalfFovy);
+	projection[1][1] = 1.0f / tanHalfFovy;
+	projection[2][2] = -(zFar + zNear) / depth;
+	projection[2][3] = -1.0f;
+	projection[3][2] = -nearFar / depth;
+
+	inverseProjection = glm::mat4(0.0f);
+	inverseProjection[0][0] = AspectRatio * tanHalfFovy;
+	inverseProjection[1][1] = tanHalfFovy;
+	inverseProjection[2][3] = -depth / nearFar;
+	inverseProjection[3][2] = -1.0f;
+	inverseProjection[3][3] = (zFar + zNear) / nearFar;
+
+	projectionZoom = Zoom;
+	projectionAspect = AspectRatio;
+	projectionNear = NearPlane;
+	projectionFar = FarPlane;
+	viewProjectionDirty = true;
+}
+
+void Camera::updateViewProjection()
+{
+	viewProjection = projection * view;
+	inverseViewProjection = inverseView * inverseProjection;
+	viewProjectionDirty = false;
+}
+
+// Attributes are public and may be written directly, so staleness is detected by comparing against the values the matrices were built from
+bool Camera::isViewDirty() const
+{
+	return Position != viewPosition || Front != viewFront || Up != viewUp;
+}
+
+bool Camera::isProjectionDirty() const
+{
+	return Zoom != projectionZoom || AspectRatio != projectionAspect || NearPlane != projectionNear || FarPlane != projectionFar;
 }
\ No newline at end of file
@@ -21,6 +21,11 @@ const float PITCH = 0.0f;
 const float SPEED = 10.0f;
 const float SENSITIVITY = 0.1f;
 const float ZOOM = 45.0f;
+const float ASPECT = 1.0f;
+const float ZNEAR = 0.1f;
+const float ZFAR = 100.0f;
+// Smallest near plane distance and frustum depth accepted by the projection matrix
+const float MIN_ZNEAR = 0.001f;
 
 
 // An abstract camera class that processes input and calculates the corresponding Euler Angles, Vectors and Matrices for use in OpenGL
@@ -40,15 +45,47 @@ public:
 	float MovementSpeed;
 	float MouseSensitivity;
 	float Zoom;
+	// Perspective projection options (Zoom is the vertical field of view in degrees)
+	float AspectRatio;
+	float NearPlane;
+	float FarPlane;
 
 	// Constructor with vectors
 	Camera(glm::vec3 position = glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f), float yaw = YAW, float pitch = PITCH);
 	Camera(float posX, float posY, float posZ, float upX, float upY, float upZ, float yaw, float pitch);
-	glm::mat4 GetViewMatrix();
+	// Matrix getters return cached results and only rebuild when the attributes they depend on have changed
+	const glm::mat4& GetViewMatrix();
+	const glm::mat4& GetInverseViewMatrix();
+	const glm::mat4& GetProjectionMatrix();
+	const glm::mat4& GetInverseProjectionMatrix();
+	const glm::mat4& GetViewProjectionMatrix();
+	const glm::mat4& GetInverseViewProjectionMatrix();
 	void ProcessKeyboard(Camera_Movement direction, float deltaTime);
 	void ProcessMouseMovement(float xoffset, float yoffset, GLboolean constrainPitch = true);
 	void ProcessMouseScroll(float yoffset);
 private:
+	// Cached matrices
+	glm::mat4 view;
+	glm::mat4 inverseView;
+	glm::mat4 projection;
+	glm::mat4 inverseProjection;
+	glm::mat4 viewProjection;
+	glm::mat4 inverseViewProjection;
+	// Attribute values the cached matrices were built from, compared against the current ones to detect stale matrices
+	glm::vec3 viewPosition;
+	glm::vec3 viewFront;
+	glm::vec3 viewUp;
+	float projectionZoom;
+	float projectionAspect;
+	float projectionNear;
+	float projectionFar;
+	bool viewProjectionDirty;
+
 	void updateCameraVectors();
+	void updateView();
+	void updateProjection();
+	void updateViewProjection();
+	bool isViewDirty() const;
+	bool isProjectionDirty() const;
 };
 #endif
\ No newline at end of file
@@ -301,7 +301,10 @@ int main(int, char**)
 		radian = camera.Zoom;	
 		
 		if (projMode == PERSPECTIVE) {
-			proj = glm::perspective(glm::radians(radian), (float)display_w / (float)display_h, nearValue, farValue);
+			camera.AspectRatio = (float)display_w / (float)display_h;
+			camera.NearPlane = nearValue;
+			camera.FarPlane = farValue;
+			proj = camera.GetProjectionMatrix();
 		}
 		else if (projMode == ORTHOGONAL) {
 			proj = glm::ortho(left, right, bottom, top, nearValue, farValue);